@@ -0,0 +1,953 @@
+//
+// auralius (manurung.auralius@gmail.com)
+//
+// Benchmark of the simulation stages over a matrix of map sizes, ray counts,
+// LIDAR_MAX values and robot counts. One result row per stage and setup, as
+// CSV or JSON lines, so the numbers can be compared between releases.
+//
+//   benchmark [--help] [--quick] [--json] [--time s] [--map png] [--config cfg]
+//             [-o file]
+//
+
+#include "fleet.H"
+#include "log_recorder.H"
+#include "range_table.H"
+#include "counter_rng.H"
+#include "config.H"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/chrono.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// ALLOCATION COUNTING
+///////////////////////////////////////////////////////////////////////////////
+
+/// Number of operator new calls of the whole program.
+static boost::atomic<long> g_alloc_num(0);
+
+void *operator new(size_t n)
+{
+    g_alloc_num.fetch_add(1, boost::memory_order_relaxed);
+    void *p = malloc(n ? n : 1);
+    if (p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t n)
+{
+    g_alloc_num.fetch_add(1, boost::memory_order_relaxed);
+    void *p = malloc(n ? n : 1);
+    if (p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p)
+{
+    free(p);
+}
+
+void operator delete[](void *p)
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t)
+{
+    free(p);
+}
+
+void operator delete[](void *p, size_t)
+{
+    free(p);
+}
+
+void *operator new(size_t n, const std::nothrow_t &) throw()
+{
+    g_alloc_num.fetch_add(1, boost::memory_order_relaxed);
+    return malloc(n ? n : 1);
+}
+
+void *operator new[](size_t n, const std::nothrow_t &) throw()
+{
+    g_alloc_num.fetch_add(1, boost::memory_order_relaxed);
+    return malloc(n ? n : 1);
+}
+
+void operator delete(void *p, const std::nothrow_t &) throw()
+{
+    free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) throw()
+{
+    free(p);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// SETUP
+///////////////////////////////////////////////////////////////////////////////
+
+/// Command line options.
+struct AZ_BENCH_OPTIONS
+{
+    /// Small matrix and short runs, e.g. for a smoke test.
+    bool quick;
+
+    /// JSON lines instead of CSV.
+    bool json;
+
+    /// Minimum measured time per result (seconds).
+    double min_time;
+
+    /// Map file to time the PNG loading, NULL to skip.
+    const char *map_fn;
+
+    /// Configuration file, the base of every setup.
+    const char *cfg_fn;
+
+    /// Result file, "-" for stdout.
+    const char *out_fn;
+};
+
+/// One result row.
+struct AZ_BENCH_RESULT
+{
+    /// Stage name.
+    const char *stage;
+
+    /// Map side (pixels), 0 if not used.
+    int map;
+
+    /// Rays per robot, 0 if not used.
+    int rays;
+
+    /// LIDAR_MAX (meters), 0 if not used.
+    double lidar_max;
+
+    /// Number of robots, 0 if not used.
+    int robots;
+
+    /// Number of measured operations.
+    long ops;
+
+    /// Wall time per operation (nanoseconds).
+    double ns_per_op;
+
+    /// Wall time per ray (nanoseconds), 0 if there are no rays.
+    double ns_per_ray;
+
+    /// Robot steps per second, 0 if the stage is not a step.
+    double steps_per_sec;
+
+    /// Allocations per operation.
+    double allocs_per_op;
+
+    /// Memory of the measured structure (bytes), 0 if not used.
+    double bytes;
+
+    /// Mean absolute range error (pixels), 0 if exact.
+    double error;
+};
+
+/// Wall time and allocations of a measured loop, it can be paused for work
+/// which is not measured.
+class CMeasure
+{
+public:
+    /// Reset and start.
+    void start()
+    {
+        m_time = 0.0;
+        m_allocs = 0;
+        resume();
+    }
+
+    void pause()
+    {
+        boost::chrono::duration<double> dt =
+            boost::chrono::steady_clock::now() - m_t0;
+        m_time = m_time + dt.count();
+        m_allocs = m_allocs + g_alloc_num.load() - m_alloc0;
+    }
+
+    void resume()
+    {
+        m_alloc0 = g_alloc_num.load();
+        m_t0 = boost::chrono::steady_clock::now();
+    }
+
+    /// Measured time while running (seconds).
+    double get_elapsed()
+    {
+        boost::chrono::duration<double> dt =
+            boost::chrono::steady_clock::now() - m_t0;
+        return m_time + dt.count();
+    }
+
+    /// Stop, and fill time and allocations per operation of a result.
+    void stop(long ops, AZ_BENCH_RESULT *r)
+    {
+        pause();
+
+        r->ops = ops;
+        r->ns_per_op = (ops > 0) ? m_time * 1e9 / ops : 0.0;
+        r->allocs_per_op = (ops > 0) ? (double) m_allocs / ops : 0.0;
+    }
+
+private:
+    double m_time;
+    long m_allocs;
+    long m_alloc0;
+    boost::chrono::steady_clock::time_point m_t0;
+};
+
+/// Robot driving around, it turns in place when the front ray is short.
+class CBenchRobot : public CRobot
+{
+public:
+    CBenchRobot(CWorld *world, const AZ_CONFIG *cfg)
+    :CRobot(world)
+    {
+        az_set_config(cfg);
+    }
+
+    virtual void az_sim_fn()
+    {
+        az_step();
+
+        if (az_get_sensor_data(0) > 0.1) {
+            az_set_lspeed(0.1);
+            az_set_rspeed(0.1);
+        }
+        else {
+            az_set_lspeed(0.1);
+            az_set_rspeed(-0.1);
+        }
+    }
+};
+
+/// Make an RGB map: walls at the border and random boxes, about 10% of the
+/// area is occupied. The same size always gives the same map.
+static std::vector<unsigned char> make_map(int size)
+{
+    std::vector<unsigned char> pixels((size_t) size * size * 3, 255);
+
+    const int wall = 4;
+    int boxes = size * size / 1600 / 4;
+    boost::uint64_t key = (boost::uint64_t) size;
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            bool black = x < wall || y < wall || x >= size - wall ||
+                y >= size - wall;
+            if (black)
+                memset(&pixels[((size_t) y * size + x) * 3], 0, 3);
+        }
+    }
+
+    for (int i = 0; i < boxes; i++) {
+        int w = 8 + (int) (32 * CCounterRng::uniform(key, 4 * i));
+        int h = 8 + (int) (32 * CCounterRng::uniform(key, 4 * i + 1));
+        int x0 = (int) ((size - w) * CCounterRng::uniform(key, 4 * i + 2));
+        int y0 = (int) ((size - h) * CCounterRng::uniform(key, 4 * i + 3));
+
+        for (int y = y0; y < y0 + h; y++)
+            memset(&pixels[((size_t) y * size + x0) * 3], 0, (size_t) w * 3);
+    }
+
+    return pixels;
+}
+
+/// Random free poses (meters) of a map, the same for the same map.
+static std::vector<CPose> make_poses(CWorld *world, const AZ_CONFIG *cfg,
+    int n)
+{
+    std::vector<CPose> poses;
+    const COccupancyGrid *grid = world->get_grid();
+    const double s = cfg->SCALE_FACTOR;
+    const double r = cfg->ROBOT_RADIUS + 2.0;
+
+    for (int i = 0; (int) poses.size() < n && i < 1000 * n; i++) {
+        double x = world->get_width() * CCounterRng::uniform(7, 3 * i);
+        double y = world->get_height() * CCounterRng::uniform(7, 3 * i + 1);
+        double th = 6.283185307179586 * CCounterRng::uniform(7, 3 * i + 2);
+
+        if (grid->is_free_disc(x, y, r))
+            poses.push_back(CPose(x / s, y / s, th));
+    }
+
+    // Full map, stack the rest in the middle
+    while ((int) poses.size() < n)
+        poses.push_back(CPose(world->get_width() / 2.0 / s,
+            world->get_height() / 2.0 / s, 0.0));
+
+    return poses;
+}
+
+/// Configuration of one setup.
+static AZ_CONFIG make_config(const AZ_CONFIG *base, int rays, double lidar_max)
+{
+    AZ_CONFIG cfg = *base;
+    cfg.LIDAR_RAYS = rays;
+    cfg.LIDAR_MAX = lidar_max * cfg.SCALE_FACTOR;
+    return cfg;
+}
+
+static void init_result(AZ_BENCH_RESULT *r, const char *stage, int map,
+    int rays, double lidar_max, int robots)
+{
+    memset(r, 0, sizeof(AZ_BENCH_RESULT));
+    r->stage = stage;
+    r->map = map;
+    r->rays = rays;
+    r->lidar_max = lidar_max;
+    r->robots = robots;
+}
+
+/// Time CRobot::az_update_all_sensors over a set of poses, one call per
+/// step.
+static void time_sensors(CBenchRobot *robot, const std::vector<CPose> &poses,
+    const AZ_BENCH_OPTIONS *o, AZ_BENCH_RESULT *r)
+{
+    robot->az_update_all_sensors(); // Warm up
+    CMeasure t;
+    long n = 0;
+    t.start();
+    do {
+        const CPose &p = poses[n % poses.size()];
+        robot->az_set_location(p.x(), p.y(), p.th());
+        robot->az_update_all_sensors();
+        n++;
+    } while (t.get_elapsed() < o->min_time);
+    t.stop(n, r);
+
+    r->ns_per_ray = r->ns_per_op / r->rays;
+    r->steps_per_sec = (r->ns_per_op > 0.0) ? 1e9 / r->ns_per_op : 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// OUTPUT
+///////////////////////////////////////////////////////////////////////////////
+
+static void write_header(FILE *f, const AZ_BENCH_OPTIONS *o)
+{
+    if (o->json)
+        return;
+
+    fprintf(f, "stage,map,rays,lidar_max,robots,ops,ns_per_op,ns_per_ray,"
+        "steps_per_sec,allocs_per_op,bytes,error\n");
+    fflush(f);
+}
+
+static void write_result(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_BENCH_RESULT *r)
+{
+    if (o->json) {
+        fprintf(f, "{\"stage\":\"%s\",\"map\":%d,\"rays\":%d,"
+            "\"lidar_max\":%g,\"robots\":%d,\"ops\":%ld,\"ns_per_op\":%.1f,"
+            "\"ns_per_ray\":%.2f,\"steps_per_sec\":%.1f,"
+            "\"allocs_per_op\":%.3f,\"bytes\":%.0f,\"error\":%.4f}\n",
+            r->stage, r->map, r->rays, r->lidar_max, r->robots, r->ops,
+            r->ns_per_op, r->ns_per_ray, r->steps_per_sec, r->allocs_per_op,
+            r->bytes, r->error);
+    }
+    else {
+        fprintf(f, "%s,%d,%d,%g,%d,%ld,%.1f,%.2f,%.1f,%.3f,%.0f,%.4f\n",
+            r->stage, r->map, r->rays, r->lidar_max, r->robots, r->ops,
+            r->ns_per_op, r->ns_per_ray, r->steps_per_sec, r->allocs_per_op,
+            r->bytes, r->error);
+    }
+    fflush(f);
+
+    fprintf(stderr, "%-14s map %5d rays %4d max %4.1f robots %4d: "
+        "%12.1f ns/op %9.2f ns/ray %12.1f steps/s %8.3f allocs/op\n",
+        r->stage, r->map, r->rays, r->lidar_max, r->robots, r->ns_per_op,
+        r->ns_per_ray, r->steps_per_sec, r->allocs_per_op);
+    fflush(stderr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// STAGES
+///////////////////////////////////////////////////////////////////////////////
+
+/// CWorld: thresholding of the RGB pixels, and loading of a PNG map.
+static void bench_world(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_CONFIG *base, const std::vector<int> &maps)
+{
+    for (size_t m = 0; m < maps.size(); m++) {
+        std::vector<unsigned char> pixels = make_map(maps[m]);
+        CWorld world(maps[m], maps[m]);
+
+        AZ_BENCH_RESULT r;
+        init_result(&r, "threshold", maps[m], 0, 0.0, 0);
+
+        CMeasure t;
+        long n = 0;
+        t.start();
+        do {
+            world.threshold_image(&pixels[0], 3);
+            n++;
+        } while (t.get_elapsed() < o->min_time);
+        t.stop(n, &r);
+
+        write_result(f, o, &r);
+    }
+
+    if (o->map_fn == NULL)
+        return;
+
+    AZ_BENCH_RESULT r;
+    CMeasure t;
+    long n = 0;
+    int w = 0;
+    t.start();
+    do {
+        CWorld world(o->map_fn, base);
+        w = world.get_width();
+        n++;
+    } while (t.get_elapsed() < o->min_time);
+
+    init_result(&r, "load_png", w, 0, 0.0, 0);
+    t.stop(n, &r);
+    write_result(f, o, &r);
+}
+
+/// CRobot::az_update_kinematics, it does not depend on the setup.
+static void bench_kinematics(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_CONFIG *base)
+{
+    CWorld world(256, 256);
+    CBenchRobot robot(&world, base);
+    robot.az_set_location(0.64, 0.64, 0.0);
+    robot.az_set_lspeed(0.1);
+    robot.az_set_rspeed(0.05);
+
+    AZ_BENCH_RESULT r;
+    init_result(&r, "kinematics", 0, 0, 0.0, 1);
+
+    CMeasure t;
+    long n = 0;
+    t.start();
+    do {
+        for (int i = 0; i < 1000; i++)
+            robot.az_update_kinematics();
+        n = n + 1000;
+    } while (t.get_elapsed() < o->min_time);
+    t.stop(n, &r);
+
+    r.steps_per_sec = (r.ns_per_op > 0.0) ? 1e9 / r.ns_per_op : 0.0;
+    write_result(f, o, &r);
+}
+
+/// CRobot::az_update_all_sensors and the per-ray CSensor::update_value.
+static void bench_sensors(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_CONFIG *base, const std::vector<int> &maps,
+    const std::vector<int> &rays, const std::vector<double> &lidar_max)
+{
+    for (size_t m = 0; m < maps.size(); m++) {
+        std::vector<unsigned char> pixels = make_map(maps[m]);
+        CWorld world(maps[m], maps[m]);
+        world.threshold_image(&pixels[0], 3);
+
+        for (size_t k = 0; k < rays.size(); k++) {
+            for (size_t l = 0; l < lidar_max.size(); l++) {
+                AZ_CONFIG cfg = make_config(base, rays[k], lidar_max[l]);
+                CBenchRobot robot(&world, &cfg);
+                std::vector<CPose> poses = make_poses(&world, &cfg, 64);
+
+                // Batch raycasting, one call per step
+                AZ_BENCH_RESULT r;
+                init_result(&r, "sensors", maps[m], rays[k], lidar_max[l], 1);
+                time_sensors(&robot, poses, o, &r);
+                write_result(f, o, &r);
+
+                // Bresenham line of every ray, one call per ray
+                init_result(&r, "update_value", maps[m], rays[k], lidar_max[l],
+                    1);
+
+                CSensor *sensors = robot.az_get_sensor_addr();
+                for (int i = 0; i < rays[k]; i++)
+                    sensors[i].set_grid(world.get_grid());
+
+                CMeasure t;
+                long n = 0;
+                t.start();
+                do {
+                    // Start and end points of the rays, not measured
+                    t.pause();
+                    const CPose &p = poses[n % poses.size()];
+                    robot.az_set_location(p.x(), p.y(), p.th());
+                    robot.az_update_all_sensors();
+                    t.resume();
+
+                    for (int i = 0; i < rays[k]; i++)
+                        sensors[i].update_value();
+                    n++;
+                } while (t.get_elapsed() < o->min_time);
+                t.stop(n, &r);
+
+                r.ns_per_ray = r.ns_per_op / rays[k];
+                write_result(f, o, &r);
+            }
+        }
+    }
+}
+
+/// CWorld::enable_distance_field: computing the field once per map, and
+/// the sensors with sphere tracing.
+static void bench_distance_field(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_CONFIG *base, const std::vector<int> &maps,
+    const std::vector<int> &rays, const std::vector<double> &lidar_max)
+{
+    for (size_t m = 0; m < maps.size(); m++) {
+        std::vector<unsigned char> pixels = make_map(maps[m]);
+        CWorld world(maps[m], maps[m]);
+        world.threshold_image(&pixels[0], 3);
+        size_t grid_bytes = world.get_grid()->get_memory_size();
+
+        AZ_BENCH_RESULT r;
+        init_result(&r, "distance_field", maps[m], 0, 0.0, 0);
+
+        CMeasure t;
+        long n = 0;
+        t.start();
+        do {
+            world.enable_distance_field(true);
+            n++;
+        } while (t.get_elapsed() < o->min_time);
+        t.stop(n, &r);
+
+        r.bytes = (double) (world.get_grid()->get_memory_size() - grid_bytes);
+        write_result(f, o, &r);
+
+        for (size_t k = 0; k < rays.size(); k++) {
+            for (size_t l = 0; l < lidar_max.size(); l++) {
+                AZ_CONFIG cfg = make_config(base, rays[k], lidar_max[l]);
+                CBenchRobot robot(&world, &cfg);
+                std::vector<CPose> poses = make_poses(&world, &cfg, 64);
+
+                init_result(&r, "sensors_sdf", maps[m], rays[k],
+                    lidar_max[l], 1);
+                time_sensors(&robot, poses, o, &r);
+                write_result(f, o, &r);
+            }
+        }
+    }
+}
+
+/// CWorld::enable_range_table: memory against accuracy of the tables of
+/// CRangeTable::report_tradeoff, mapping a cached table, and the sensors
+/// reading the table.
+static void bench_range_table(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_CONFIG *base, const std::vector<int> &maps,
+    const std::vector<int> &rays, const std::vector<double> &lidar_max)
+{
+    const char *cache_fn = "benchmark_range.bin";
+    const int downsample[] = {1, 2, 4, 8};
+    const int n_angles = o->quick ? 90 : 360;
+    const int samples = o->quick ? 2000 : 20000;
+
+    // Reaches LIDAR_MAX of every setup
+    double max_lidar = 0.0;
+    for (size_t l = 0; l < lidar_max.size(); l++) {
+        if (lidar_max[l] > max_lidar)
+            max_lidar = lidar_max[l];
+    }
+    const double max_range = max_lidar * base->SCALE_FACTOR;
+
+    for (size_t m = 0; m < maps.size(); m++) {
+        std::vector<unsigned char> pixels = make_map(maps[m]);
+        CWorld world(maps[m], maps[m]);
+        world.threshold_image(&pixels[0], 3);
+        const COccupancyGrid *grid = world.get_grid();
+
+        // Building a table, once per setup
+        for (int i = 0; i < 4; i++) {
+            for (int q = 0; q < 2; q++) {
+                AZ_BENCH_RESULT r;
+                init_result(&r, q ? "range_table_8" : "range_table_16",
+                    maps[m], n_angles, max_lidar, 0);
+
+                CMeasure t;
+                t.start();
+                int ret = world.enable_range_table(n_angles, max_range,
+                    downsample[i], q == 1, NULL);
+                t.stop(1, &r);
+
+                // Too large, see AZ_RANGE_TABLE_MAX_SIZE
+                if (ret == -1)
+                    continue;
+
+                double rms;
+                double max;
+                const CRangeTable *table = world.get_range_table();
+                table->get_error(grid, samples, r.error, rms, max);
+                r.bytes = (double) table->get_memory_size();
+                r.ns_per_ray = r.ns_per_op * (q ? 1 : 2) / r.bytes;
+                write_result(f, o, &r);
+
+                // Human readable, as report_tradeoff() prints it
+                table->report(grid, samples, stderr);
+            }
+        }
+
+        // Sensors reading the table, the finest table which fits
+        int ds = 0;
+        for (int i = 0; i < 4 && ds == 0; i++) {
+            if (world.enable_range_table(n_angles, max_range, downsample[i],
+                false, cache_fn) != -1)
+                ds = downsample[i];
+        }
+        if (ds == 0)
+            continue;
+
+        // Mapping the cache file written above
+        AZ_BENCH_RESULT r;
+        init_result(&r, "range_cache", maps[m], n_angles, max_lidar, 0);
+
+        CMeasure t;
+        long n = 0;
+        t.start();
+        do {
+            world.enable_range_table(n_angles, max_range, ds, false, cache_fn);
+            n++;
+        } while (t.get_elapsed() < o->min_time);
+        t.stop(n, &r);
+
+        r.bytes = (double) world.get_range_table()->get_memory_size();
+        write_result(f, o, &r);
+
+        for (size_t k = 0; k < rays.size(); k++) {
+            for (size_t l = 0; l < lidar_max.size(); l++) {
+                AZ_CONFIG cfg = make_config(base, rays[k], lidar_max[l]);
+                CBenchRobot robot(&world, &cfg);
+                std::vector<CPose> poses = make_poses(&world, &cfg, 64);
+
+                init_result(&r, "sensors_table", maps[m], rays[k],
+                    lidar_max[l], 1);
+                time_sensors(&robot, poses, o, &r);
+                write_result(f, o, &r);
+            }
+        }
+
+        world.disable_range_table();
+        remove(cache_fn);
+    }
+}
+
+/// CRobot::az_update_odom_likelihood: beam model likelihood of every
+/// odometry sample, on the calling thread and spread over a thread pool.
+/// One operation is one sample.
+static void bench_likelihood(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_CONFIG *base, const std::vector<int> &maps,
+    const std::vector<int> &rays, const std::vector<double> &lidar_max)
+{
+    const int samples = o->quick ? 200 : 1000;
+    CThreadPool pool;
+
+    for (size_t m = 0; m < maps.size(); m++) {
+        std::vector<unsigned char> pixels = make_map(maps[m]);
+        CWorld world(maps[m], maps[m]);
+        world.threshold_image(&pixels[0], 3);
+
+        for (size_t k = 0; k < rays.size(); k++) {
+            for (size_t l = 0; l < lidar_max.size(); l++) {
+                AZ_CONFIG cfg = make_config(base, rays[k], lidar_max[l]);
+                cfg.ODOM_SAMPLES = samples;
+
+                CBenchRobot robot(&world, &cfg);
+                std::vector<CPose> poses = make_poses(&world, &cfg, 1);
+                robot.az_set_location(poses[0].x(), poses[0].y(),
+                    poses[0].th());
+                robot.az_enable_odom_samples(true);
+
+                // Spread the samples around the robot
+                robot.az_set_lspeed(0.1);
+                robot.az_set_rspeed(0.08);
+                for (int i = 0; i < 20; i++)
+                    robot.az_step();
+                robot.az_update_all_sensors();
+
+                for (int p = 0; p < 2; p++) {
+                    CThreadPool *threads = p ? &pool : NULL;
+
+                    AZ_BENCH_RESULT r;
+                    init_result(&r, p ? "likelihood_mt" : "likelihood",
+                        maps[m], rays[k], lidar_max[l], 1);
+
+                    robot.az_update_odom_likelihood(1, threads); // Warm up
+                    CMeasure t;
+                    long n = 0;
+                    t.start();
+                    do {
+                        robot.az_update_odom_likelihood(1, threads);
+                        n = n + samples;
+                    } while (t.get_elapsed() < o->min_time);
+                    t.stop(n, &r);
+
+                    r.ns_per_ray = r.ns_per_op / rays[k];
+                    write_result(f, o, &r);
+                }
+            }
+        }
+    }
+}
+
+/// Text log of CRobot::az_log_sensor and binary log of CLogRecorder.
+static void bench_logging(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_CONFIG *base, const std::vector<int> &rays)
+{
+    const char *text_fn = "benchmark_log.txt";
+    const char *bin_fn = "benchmark_log.bin";
+
+    std::vector<unsigned char> pixels = make_map(256);
+    CWorld world(256, 256);
+    world.threshold_image(&pixels[0], 3);
+
+    for (size_t k = 0; k < rays.size(); k++) {
+        AZ_CONFIG cfg = make_config(base, rays[k], 1.0);
+        CBenchRobot robot(&world, &cfg);
+        std::vector<CPose> poses = make_poses(&world, &cfg, 1);
+        robot.az_set_location(poses[0].x(), poses[0].y(), poses[0].th());
+        robot.az_update_all_sensors();
+
+        // One line per step, the file is opened every time
+        AZ_BENCH_RESULT r;
+        init_result(&r, "log_text", 0, rays[k], 1.0, 1);
+
+        remove(text_fn);
+        CMeasure t;
+        long n = 0;
+        t.start();
+        do {
+            robot.az_log_sensor(text_fn);
+            n++;
+        } while (t.get_elapsed() < o->min_time);
+        t.stop(n, &r);
+        remove(text_fn);
+
+        r.ns_per_ray = r.ns_per_op / rays[k];
+        write_result(f, o, &r);
+
+        // One record per step, as CRobot does with a recorder
+        init_result(&r, "log_binary", 0, rays[k], 1.0, 1);
+
+        CLogRecorder rec(rays[k]);
+        if (rec.open(bin_fn) == -1)
+            continue;
+
+        CSensor *sensors = robot.az_get_sensor_addr();
+        n = 0;
+        t.start();
+        do {
+            AZ_LOG_RECORD *l = rec.begin_push();
+            l->step = (int) n;
+            l->time = n * robot.az_get_time_step();
+            l->x = robot.az_get_pos_x();
+            l->y = robot.az_get_pos_y();
+            l->th = robot.az_get_angle();
+            l->lspeed = robot.az_get_lspeed();
+            l->rspeed = robot.az_get_rspeed();
+
+            float *range = CLogRecorder::get_ranges(l);
+            for (int i = 0; i < rays[k]; i++)
+                range[i] = (float) (sensors[i].get_value() / cfg.SCALE_FACTOR);
+
+            rec.end_push();
+            n++;
+        } while (t.get_elapsed() < o->min_time);
+        t.stop(n, &r);
+        rec.close();
+        remove(bin_fn);
+
+        r.ns_per_ray = r.ns_per_op / rays[k];
+        write_result(f, o, &r);
+    }
+}
+
+/// Complete steps of CFleet, robots are stepped in parallel.
+static void bench_fleet(FILE *f, const AZ_BENCH_OPTIONS *o,
+    const AZ_CONFIG *base, const std::vector<int> &maps,
+    const std::vector<int> &rays, const std::vector<double> &lidar_max,
+    const std::vector<int> &robots)
+{
+    for (size_t m = 0; m < maps.size(); m++) {
+        std::vector<unsigned char> pixels = make_map(maps[m]);
+
+        for (size_t k = 0; k < rays.size(); k++) {
+            for (size_t l = 0; l < lidar_max.size(); l++) {
+                for (size_t q = 0; q < robots.size(); q++) {
+                    AZ_CONFIG cfg = make_config(base, rays[k], lidar_max[l]);
+
+                    CFleet fleet(o->cfg_fn, maps[m], maps[m]);
+                    fleet.enable_recording(false);
+                    CWorld *world = fleet.get_world();
+                    world->threshold_image(&pixels[0], 3);
+
+                    std::vector<CPose> poses = make_poses(world, &cfg,
+                        robots[q]);
+                    for (int i = 0; i < robots[q]; i++) {
+                        CBenchRobot *b = new CBenchRobot(world, &cfg);
+                        b->az_set_location(poses[i].x(), poses[i].y(),
+                            poses[i].th());
+                        fleet.add_robot(b);
+                    }
+
+                    // Warm up, and find the number of steps for min_time
+                    fleet.run(10);
+                    double sps = fleet.get_steps_per_sec() / robots[q];
+                    int steps = (int) (sps * o->min_time);
+                    if (steps < 10)
+                        steps = 10;
+
+                    AZ_BENCH_RESULT r;
+                    init_result(&r, "fleet", maps[m], rays[k], lidar_max[l],
+                        robots[q]);
+
+                    CMeasure t;
+                    t.start();
+                    int n = fleet.run(steps);
+                    t.stop((long) n * robots[q], &r);
+
+                    // Rate of the robot steps only, without az_prepare_sim
+                    r.steps_per_sec = fleet.get_steps_per_sec();
+                    r.ns_per_op = (r.steps_per_sec > 0.0) ?
+                        1e9 / r.steps_per_sec : 0.0;
+                    r.ns_per_ray = (fleet.get_rays_per_sec() > 0.0) ?
+                        1e9 / fleet.get_rays_per_sec() : 0.0;
+                    write_result(f, o, &r);
+                }
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// MAIN
+///////////////////////////////////////////////////////////////////////////////
+
+static void usage(FILE *f)
+{
+    fprintf(f,
+        "Usage: benchmark [options]\n"
+        "  -h, --help     Print this help\n"
+        "  --quick        Small matrix and short runs\n"
+        "  --json         JSON lines instead of CSV\n"
+        "  --time s       Minimum measured time per result (seconds)\n"
+        "  --map png      Also time loading this PNG map\n"
+        "  --config cfg   Configuration file (default ../../src/robot.CFG)\n"
+        "  -o file        Result file, - for stdout (default benchmark.csv)\n");
+    fflush(f);
+}
+
+int main(int argc, char **argv)
+{
+    AZ_BENCH_OPTIONS o;
+    o.quick = false;
+    o.json = false;
+    o.min_time = -1.0;
+    o.map_fn = NULL;
+    o.cfg_fn = "../../src/robot.CFG";
+    o.out_fn = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            usage(stdout);
+            return 0;
+        }
+        else if (strcmp(argv[i], "--quick") == 0)
+            o.quick = true;
+        else if (strcmp(argv[i], "--json") == 0)
+            o.json = true;
+        else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc)
+            o.min_time = atof(argv[++i]);
+        else if (strcmp(argv[i], "--map") == 0 && i + 1 < argc)
+            o.map_fn = argv[++i];
+        else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc)
+            o.cfg_fn = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            o.out_fn = argv[++i];
+        else {
+            usage(stderr);
+            return -1;
+        }
+    }
+
+    if (o.min_time <= 0.0)
+        o.min_time = o.quick ? 0.05 : 0.25;
+    if (o.out_fn == NULL)
+        o.out_fn = o.json ? "benchmark.json" : "benchmark.csv";
+
+    // Every setup starts from the configuration file
+    CConfig c;
+    if (c.read_config_file(o.cfg_fn) == -1) {
+        fprintf(stderr, "Error loading config file: %s.\nFile not found!\n" \
+            "Using default configuration.\n" , o.cfg_fn);
+        fflush(stderr);
+    }
+    AZ_CONFIG base;
+    c.copy_to(&base);
+
+    // The matrix
+    std::vector<int> maps;
+    std::vector<int> rays;
+    std::vector<double> lidar_max;
+    std::vector<int> robots;
+
+    if (o.quick) {
+        maps.push_back(256);
+        rays.push_back(36);
+        rays.push_back(360);
+        lidar_max.push_back(0.3);
+        lidar_max.push_back(3.0);
+        robots.push_back(1);
+        robots.push_back(16);
+    }
+    else {
+        maps.push_back(256);
+        maps.push_back(1024);
+        maps.push_back(2048);
+        rays.push_back(36);
+        rays.push_back(180);
+        rays.push_back(720);
+        lidar_max.push_back(0.3);
+        lidar_max.push_back(1.0);
+        lidar_max.push_back(3.0);
+        robots.push_back(1);
+        robots.push_back(16);
+        robots.push_back(128);
+    }
+
+    FILE *f = stdout;
+    if (strcmp(o.out_fn, "-") != 0) {
+        f = fopen(o.out_fn, "w");
+        if (f == NULL) {
+            fprintf(stderr, "Can not open %s\n", o.out_fn);
+            fflush(stderr);
+            return -1;
+        }
+    }
+
+    write_header(f, &o);
+    bench_world(f, &o, &base, maps);
+    bench_kinematics(f, &o, &base);
+    bench_sensors(f, &o, &base, maps, rays, lidar_max);
+    bench_distance_field(f, &o, &base, maps, rays, lidar_max);
+    bench_range_table(f, &o, &base, maps, rays, lidar_max);
+    bench_likelihood(f, &o, &base, maps, rays, lidar_max);
+    bench_logging(f, &o, &base, rays);
+    bench_fleet(f, &o, &base, maps, rays, lidar_max, robots);
+
+    if (f != stdout)
+        fclose(f);
+
+    return 0;
+}
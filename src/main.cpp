@@ -2,7 +2,9 @@
 // auralius (manurung.auralius@gmail.com)
 //
 
+#include "simulation_window.H"
 #include "robot.H"
+#include "profiler.H"
 
 class CMyRobot : public CRobot
 {
@@ -41,5 +43,8 @@ INT WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
 
     CMyRobot robot(&win);
 
+    // There is no console, timings of AZ_PROFILE go to a file on exit
+    CProfiler::set_dump_file("profile.txt");
+
     return(Fl::run());
 }
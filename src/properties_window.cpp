@@ -1,11 +1,29 @@
 #include "properties_window.h"
 #include "robot.H"
 
+#include <stdio.h>
+#include <string>
+
+/// Width of a formatted sensor value, the same for every value so a value
+/// can be replaced in place.
+#define AZ_VALUE_WIDTH 9
+
+/// Format a sensor value with AZ_VALUE_WIDTH characters.
+static void format_value(char *buf, double v)
+{
+    if (v > 99999.99)
+        v = 99999.99;
+    else if (v < -9999.99)
+        v = -9999.99;
+
+    sprintf(buf, "%9.2f", v);
+}
+
 
 CPropertiesWindow::CPropertiesWindow(int w, int h, const char *l)
     :Fl_Window(0, 0, w, h, l)
 {
-    m_robot == NULL;
+    m_robot = NULL;
     m_disp = new Fl_Text_Editor(20, 20, 640 - 40, 480 - 40, l);
     m_tbuff = new Fl_Text_Buffer(0, 4096); 
     m_disp->textfont(FL_COURIER);
@@ -29,6 +47,41 @@ void CPropertiesWindow::set_text(const char *t)
     m_tbuff->text(t);
 }
 
+void CPropertiesWindow::set_sensor_values(const double *v, int n)
+{
+    char buf[32];
+
+    // First time or different number of rays: write the whole text
+    if (n != (int) m_values.size()) {
+        sprintf(buf, "%d", n);
+        std::string s = std::string("Number of sensor rays = ") + buf + "\n\n";
+
+        m_values.resize(n);
+        m_value_pos.resize(n);
+        for (int i = 0; i < n; i++) {
+            sprintf(buf, "Ray-%d = ", i);
+            s = s + buf;
+
+            m_value_pos[i] = (int) s.size();
+            m_values[i] = v[i];
+            format_value(buf, v[i]);
+            s = s + buf + "\n";
+        }
+
+        m_tbuff->text(s.c_str());
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (v[i] == m_values[i])
+            continue;
+
+        m_values[i] = v[i];
+        format_value(buf, v[i]);
+        m_tbuff->replace(m_value_pos[i], m_value_pos[i] + AZ_VALUE_WIDTH, buf);
+    }
+}
+
 void CPropertiesWindow::clean_memory()
 {
     m_tbuff->text("");
@@ -4,6 +4,8 @@
 #include <FL/Fl_Window.H>
 #include <FL/Fl_Text_Editor.H>
 
+#include <vector>
+
 
 class CRobot; // Forward declaration
 
@@ -14,12 +16,26 @@ public:
     ~CPropertiesWindow(void);
     void set_robot_addr(CRobot *r);
     void set_text(const char *t);
+
+    /**
+     * Show sensor values, only the values that changed since the last call
+     * are formatted and replaced in the text buffer.
+     * @param v Array of sensor values
+     * @param n Number of values
+     */
+    void set_sensor_values(const double *v, int n);
     void clean_memory();
 
 private:
     Fl_Text_Editor *m_disp;
     Fl_Text_Buffer *m_tbuff;
 
+    /// Sensor values shown, to find the ones that changed.
+    std::vector<double> m_values;
+
+    /// Position of every sensor value in m_tbuff.
+    std::vector<int> m_value_pos;
+
     CRobot *m_robot;
 };
 
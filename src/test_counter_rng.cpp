@@ -0,0 +1,71 @@
+/**
+ *  @file   test_counter_rng.cpp
+ *  @brief  Contains unit tests of CCounterRng
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "counter_rng.H"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(counter_rng)
+
+BOOST_AUTO_TEST_CASE(deterministic)
+{
+    for (boost::uint64_t c = 0; c < 1000; c++) {
+        BOOST_REQUIRE_EQUAL(CCounterRng::bits(42, c), CCounterRng::bits(42, c));
+        BOOST_REQUIRE_EQUAL(CCounterRng::uniform(42, c),
+            CCounterRng::uniform(42, c));
+    }
+
+    // Other keys and counters give other streams
+    int same = 0;
+    for (boost::uint64_t c = 0; c < 1000; c++) {
+        if (CCounterRng::bits(42, c) == CCounterRng::bits(43, c))
+            same++;
+        if (CCounterRng::bits(42, c) == CCounterRng::bits(42, c + 1))
+            same++;
+    }
+    BOOST_CHECK_EQUAL(same, 0);
+}
+
+BOOST_AUTO_TEST_CASE(uniform)
+{
+    const int n = 100000;
+    double sum = 0.0;
+    int bins[10] = {0};
+
+    for (int i = 0; i < n; i++) {
+        double u = CCounterRng::uniform(7, i);
+        BOOST_REQUIRE(u > 0.0 && u <= 1.0);
+        sum += u;
+        bins[(u < 1.0) ? (int) (u * 10) : 9]++;
+    }
+
+    BOOST_CHECK_CLOSE(sum / n, 0.5, 1.0);
+    for (int b = 0; b < 10; b++)
+        BOOST_CHECK_CLOSE((double) bins[b], n / 10.0, 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(gaussian)
+{
+    const int n = 100000;
+    double sum = 0.0;
+    double sum2 = 0.0;
+
+    for (int i = 0; i < n; i++) {
+        double g0, g1;
+        CCounterRng::gaussian2(11, i, g0, g1);
+        BOOST_REQUIRE_EQUAL(g0, CCounterRng::gaussian(11, i));
+        sum += g0 + g1;
+        sum2 += g0 * g0 + g1 * g1;
+    }
+
+    double mean = sum / (2 * n);
+    double var = sum2 / (2 * n) - mean * mean;
+    BOOST_CHECK_SMALL(mean, 0.01);
+    BOOST_CHECK_CLOSE(var, 1.0, 2.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+/**
+ *  @file   test_fleet.cpp
+ *  @brief  Contains unit tests of CFleet
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "fleet.H"
+#include "config.H"
+
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+/// Drive straight, turn in front of walls and other robots.
+class CFleetTestRobot : public CRobot
+{
+public:
+    CFleetTestRobot(CWorld *world, const AZ_CONFIG *cfg)
+    :CRobot(world)
+    {
+        az_set_config(cfg);
+    }
+
+    virtual void az_sim_fn()
+    {
+        az_step();
+
+        if (az_get_sensor_data(0) > 0.15) {
+            az_set_lspeed(0.2);
+            az_set_rspeed(0.2);
+        }
+        else {
+            az_set_lspeed(0.2);
+            az_set_rspeed(-0.2);
+        }
+    }
+};
+
+/// Stand still, configured by the fleet.
+class CIdleTestRobot : public CRobot
+{
+public:
+    CIdleTestRobot(CWorld *world)
+    :CRobot(world)
+    {
+    }
+
+    virtual void az_sim_fn()
+    {
+        az_step();
+    }
+};
+
+/// Trajectories and scans of all robots of one run.
+struct AZ_TEST_FLEET_RUN
+{
+    std::vector<std::vector<CPose> > trajectories;
+    std::vector<std::vector<double> > scans;
+};
+
+/// Run a noisy fleet of robots in a walled world with a box.
+static AZ_TEST_FLEET_RUN run_fleet(int threads, int robots, int steps)
+{
+    CConfig c;
+    AZ_CONFIG cfg;
+    c.copy_to(&cfg);
+    cfg.LIDAR_RAYS = 36;
+    cfg.LIDAR_START_ANGLE = 0.0;
+    cfg.LIDAR_SWEEP_ANGLE = 6.283185307179586;
+
+    CFleet fleet("robot.CFG", 400, 400, threads);
+    BOOST_REQUIRE_EQUAL(fleet.get_thread_num(), threads);
+
+    COccupancyGrid *grid = fleet.get_world()->get_grid();
+    for (int i = 0; i < 400; i++) {
+        for (int k = 0; k < 4; k++) {
+            grid->set_occupied(i, k, true);
+            grid->set_occupied(i, 399 - k, true);
+            grid->set_occupied(k, i, true);
+            grid->set_occupied(399 - k, i, true);
+        }
+    }
+    for (int y = 180; y < 220; y++)
+        for (int x = 180; x < 220; x++)
+            grid->set_occupied(x, y, true);
+
+    // Robots in a ring around the box, all heading into the box
+    for (int i = 0; i < robots; i++) {
+        double a = 6.283185307179586 * i / robots;
+        CFleetTestRobot *r = new CFleetTestRobot(fleet.get_world(), &cfg);
+        r->az_set_location((200.0 + 120.0 * cos(a)) / cfg.SCALE_FACTOR,
+            (200.0 + 120.0 * sin(a)) / cfg.SCALE_FACTOR, a + 3.14159);
+        r->az_set_noise_seed(i + 1);
+        r->az_enable_noise(true);
+        fleet.add_robot(r);
+    }
+
+    BOOST_REQUIRE_EQUAL(fleet.run(steps), steps);
+
+    AZ_TEST_FLEET_RUN run;
+    for (int i = 0; i < robots; i++) {
+        run.trajectories.push_back(fleet.get_trajectory(i));
+        run.scans.push_back(fleet.get_scans(i));
+    }
+    return run;
+}
+
+static void check_equal(const AZ_TEST_FLEET_RUN &a, const AZ_TEST_FLEET_RUN &b)
+{
+    BOOST_REQUIRE_EQUAL(a.trajectories.size(), b.trajectories.size());
+
+    for (size_t i = 0; i < a.trajectories.size(); i++) {
+        BOOST_REQUIRE_EQUAL(a.trajectories[i].size(), b.trajectories[i].size());
+        for (size_t k = 0; k < a.trajectories[i].size(); k++) {
+            const CPose &p = a.trajectories[i][k];
+            const CPose &q = b.trajectories[i][k];
+            BOOST_REQUIRE(p.x() == q.x() && p.y() == q.y() && p.th() == q.th());
+        }
+
+        BOOST_REQUIRE(a.scans[i] == b.scans[i]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(fleet)
+
+BOOST_AUTO_TEST_CASE(deterministic)
+{
+    AZ_TEST_FLEET_RUN a = run_fleet(2, 8, 150);
+    AZ_TEST_FLEET_RUN b = run_fleet(2, 8, 150);
+    check_equal(a, b);
+
+    // The robots moved and saw something
+    BOOST_CHECK(a.trajectories[0].front().x() != a.trajectories[0].back().x());
+    BOOST_CHECK_EQUAL(a.scans[0].size(), 151u * 36);
+}
+
+BOOST_AUTO_TEST_CASE(thread_number)
+{
+    // Same result whatever robot runs on whatever thread
+    AZ_TEST_FLEET_RUN a = run_fleet(1, 8, 150);
+    AZ_TEST_FLEET_RUN b = run_fleet(4, 8, 150);
+    check_equal(a, b);
+}
+
+BOOST_AUTO_TEST_CASE(robot_config)
+{
+    // Same file as the fleet, the defaults if it is missing
+    CConfig c;
+    c.read_config_file("robot.CFG");
+    AZ_CONFIG file_cfg;
+    c.copy_to(&file_cfg);
+
+    AZ_CONFIG own = file_cfg;
+    own.LIDAR_RAYS = file_cfg.LIDAR_RAYS + 5;
+
+    CFleet fleet("robot.CFG", 200, 200, 2);
+    CRobot *bare = new CIdleTestRobot(fleet.get_world());
+    CRobot *configured = new CFleetTestRobot(fleet.get_world(), &own);
+    fleet.add_robot(bare);
+    fleet.add_robot(configured);
+
+    // Only the robot without configuration gets the one of the fleet
+    BOOST_REQUIRE(bare->az_get_sensor_addr() != NULL);
+    BOOST_CHECK_EQUAL(bare->az_get_config()->LIDAR_RAYS, file_cfg.LIDAR_RAYS);
+    BOOST_CHECK_EQUAL(bare->az_get_config()->ROBOT_DIAMETER,
+        file_cfg.ROBOT_DIAMETER);
+    BOOST_CHECK_EQUAL(configured->az_get_config()->LIDAR_RAYS, own.LIDAR_RAYS);
+
+    BOOST_REQUIRE_EQUAL(fleet.run(5), 5);
+    BOOST_CHECK_EQUAL(fleet.get_scans(0).size(), 6u * file_cfg.LIDAR_RAYS);
+    BOOST_CHECK_EQUAL(fleet.get_scans(1).size(), 6u * own.LIDAR_RAYS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
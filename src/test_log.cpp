@@ -0,0 +1,267 @@
+/**
+ *  @file   test_log.cpp
+ *  @brief  Contains unit tests of CLogRecorder, CLogReader and the replay
+ *          of CRobot
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "log_recorder.H"
+#include "log_reader.H"
+#include "robot.H"
+#include "world.H"
+#include "config.H"
+
+#include <stdio.h>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+/// Log file written by the tests, in the working directory.
+static const char *g_log_fn = "test_log.bin";
+
+/// Drive straight, turn in front of walls.
+class CLogTestRobot : public CRobot
+{
+public:
+    CLogTestRobot(CWorld *world, const AZ_CONFIG *cfg)
+    :CRobot(world)
+    {
+        az_set_config(cfg);
+    }
+
+    virtual void az_sim_fn()
+    {
+        az_step();
+
+        if (az_get_sensor_data(0) > 0.2) {
+            az_set_lspeed(0.3);
+            az_set_rspeed(0.25);
+        }
+        else {
+            az_set_lspeed(0.2);
+            az_set_rspeed(-0.2);
+        }
+    }
+};
+
+/// Record i of the synthetic log.
+static void fill_record(AZ_LOG_RECORD *r, int i)
+{
+    r->step = i;
+    r->time = i * 0.02;
+    r->x = 0.5 + 0.001 * i;
+    r->y = 1.5 - 0.002 * i;
+    r->th = 0.01 * i;
+    r->lspeed = 0.1;
+    r->rspeed = -0.1 * (i % 3);
+
+    float *range = CLogRecorder::get_ranges(r);
+    for (int k = 0; k < r->ray_num; k++)
+        range[k] = (float) ((i * 31 + k * 7) % 100) * 0.01f;
+}
+
+/// Full turn LIDAR with the default robot.
+static AZ_CONFIG make_config()
+{
+    CConfig c;
+    AZ_CONFIG cfg;
+    c.copy_to(&cfg);
+    cfg.LIDAR_RAYS = 24;
+    cfg.LIDAR_START_ANGLE = 0.0;
+    cfg.LIDAR_SWEEP_ANGLE = 6.283185307179586;
+    return cfg;
+}
+
+/// Walls at the border of the world.
+static void make_walls(CWorld *world)
+{
+    COccupancyGrid *grid = world->get_grid();
+    int w = world->get_width();
+    int h = world->get_height();
+
+    for (int x = 0; x < w; x++) {
+        grid->set_occupied(x, 0, true);
+        grid->set_occupied(x, h - 1, true);
+    }
+    for (int y = 0; y < h; y++) {
+        grid->set_occupied(0, y, true);
+        grid->set_occupied(w - 1, y, true);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(log_file)
+
+BOOST_AUTO_TEST_CASE(record_read)
+{
+    const int n = 1000;
+    const int rays = 37;
+
+    for (int c = 0; c < 2; c++) {
+        // Small ring and odd chunks, the writer wraps and the last chunk
+        // is partial
+        CLogRecorder rec(rays, 64, 100, c == 1);
+        BOOST_REQUIRE_EQUAL(rec.open(g_log_fn), 0);
+        BOOST_REQUIRE_EQUAL(rec.attach(&rec), 0);
+
+        for (int i = 0; i < n; i++) {
+            fill_record(rec.begin_push(), i);
+            rec.end_push();
+        }
+        rec.close();
+        BOOST_CHECK_EQUAL(rec.get_written_num(), n);
+
+        std::vector<unsigned char> buf(CLogRecorder::get_record_size(rays));
+        AZ_LOG_RECORD *expected = (AZ_LOG_RECORD *) &buf[0];
+        expected->ray_num = rays;
+
+        CLogReader reader;
+        BOOST_REQUIRE_EQUAL(reader.open(g_log_fn), 0);
+        BOOST_REQUIRE_EQUAL(reader.get_record_num(), n);
+        BOOST_REQUIRE_EQUAL(reader.get_ray_num(), rays);
+
+        // Backwards too, chunks are loaded again
+        for (int j = 0; j < 2 * n; j++) {
+            int i = (j < n) ? j : 2 * n - 1 - j;
+            const AZ_LOG_RECORD *r = reader.get_record(i);
+            BOOST_REQUIRE(r != NULL);
+            fill_record(expected, i);
+
+            BOOST_REQUIRE_EQUAL(r->step, expected->step);
+            BOOST_REQUIRE_EQUAL(r->ray_num, rays);
+            BOOST_REQUIRE(r->time == expected->time && r->x == expected->x &&
+                r->y == expected->y && r->th == expected->th &&
+                r->lspeed == expected->lspeed && r->rspeed == expected->rspeed);
+
+            const float *range = CLogReader::get_ranges(r);
+            const float *range0 = CLogRecorder::get_ranges(expected);
+            for (int k = 0; k < rays; k++)
+                BOOST_REQUIRE_EQUAL(range[k], range0[k]);
+        }
+
+        BOOST_CHECK(reader.get_record(n) == NULL);
+        BOOST_CHECK(reader.get_record(-1) == NULL);
+        reader.close();
+        remove(g_log_fn);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(robot_replay)
+{
+    const int steps = 300;
+    const AZ_CONFIG cfg = make_config();
+
+    CWorld world(300, 300);
+    make_walls(&world);
+
+    // Record a noisy run
+    std::vector<double> poses;
+    std::vector<double> ranges;
+    {
+        CLogTestRobot robot(&world, &cfg);
+        robot.az_set_location(150.0 / cfg.SCALE_FACTOR,
+            150.0 / cfg.SCALE_FACTOR, 0.5);
+        robot.az_set_noise_seed(3);
+        robot.az_enable_noise(true);
+
+        CLogRecorder rec(cfg.LIDAR_RAYS, 128, 50, true);
+        BOOST_REQUIRE_EQUAL(rec.open(g_log_fn), 0);
+        BOOST_REQUIRE_EQUAL(robot.az_set_recorder(&rec), 0);
+
+        robot.az_prepare_sim();
+        for (int i = 0; i <= steps; i++) {
+            if (i > 0)
+                robot.az_sim_fn();
+
+            poses.push_back(robot.az_get_pos_x());
+            poses.push_back(robot.az_get_pos_y());
+            poses.push_back(robot.az_get_angle());
+            for (int k = 0; k < cfg.LIDAR_RAYS; k++)
+                ranges.push_back(robot.az_get_sensor_addr()[k].get_value() /
+                    cfg.SCALE_FACTOR);
+        }
+
+        robot.az_set_recorder(NULL);
+        rec.close();
+        BOOST_REQUIRE_EQUAL(rec.get_written_num(), steps + 1);
+    }
+
+    // Replay it, the robot does not move by itself
+    CLogReader reader;
+    BOOST_REQUIRE_EQUAL(reader.open(g_log_fn), 0);
+
+    // Noise of its own live step must not be added to the recorded ranges
+    CLogTestRobot robot(&world, &cfg);
+    robot.az_set_location(100.0 / cfg.SCALE_FACTOR,
+        100.0 / cfg.SCALE_FACTOR, 0.0);
+    robot.az_set_noise_seed(4);
+    robot.az_enable_noise(true);
+    robot.az_prepare_sim();
+    BOOST_REQUIRE_EQUAL(robot.az_set_replay(&reader), 0);
+
+    robot.az_prepare_sim();
+    for (int i = 0; i <= steps; i++) {
+        if (i > 0)
+            robot.az_sim_fn();
+
+        BOOST_REQUIRE_EQUAL(robot.az_get_pos_x(), poses[3 * i]);
+        BOOST_REQUIRE_EQUAL(robot.az_get_pos_y(), poses[3 * i + 1]);
+        BOOST_REQUIRE_EQUAL(robot.az_get_angle(), poses[3 * i + 2]);
+
+        // Ranges are stored as floats
+        for (int k = 0; k < cfg.LIDAR_RAYS; k++) {
+            double v = robot.az_get_sensor_addr()[k].get_value() /
+                cfg.SCALE_FACTOR;
+            BOOST_REQUIRE_SMALL(v - ranges[i * cfg.LIDAR_RAYS + k], 1e-5);
+        }
+    }
+    BOOST_CHECK(robot.az_is_replay_done());
+
+    robot.az_set_replay(NULL);
+    reader.close();
+    remove(g_log_fn);
+}
+
+BOOST_AUTO_TEST_CASE(push_after_close)
+{
+    const AZ_CONFIG cfg = make_config();
+
+    CWorld world(300, 300);
+    make_walls(&world);
+
+    CLogTestRobot robot(&world, &cfg);
+    robot.az_set_location(150.0 / cfg.SCALE_FACTOR,
+        150.0 / cfg.SCALE_FACTOR, 0.0);
+
+    // Nothing would write its records
+    CLogRecorder rec(cfg.LIDAR_RAYS, 4, 2);
+    BOOST_CHECK(!rec.is_open());
+    BOOST_CHECK_EQUAL(robot.az_set_recorder(&rec), -1);
+    BOOST_CHECK(rec.begin_push() == NULL);
+    BOOST_CHECK_EQUAL(rec.get_dropped_num(), 1);
+
+    BOOST_REQUIRE_EQUAL(rec.open(g_log_fn), 0);
+    BOOST_CHECK(rec.is_open());
+    BOOST_CHECK_EQUAL(rec.get_dropped_num(), 0);
+    BOOST_REQUIRE_EQUAL(robot.az_set_recorder(&rec), 0);
+
+    // Reopening would reset the ring buffer under the robot
+    BOOST_CHECK_EQUAL(rec.open(g_log_fn), -1);
+    BOOST_CHECK(rec.is_open());
+
+    robot.az_prepare_sim();
+    for (int i = 0; i < 10; i++)
+        robot.az_sim_fn();
+    rec.close();
+    BOOST_CHECK_EQUAL(rec.get_written_num(), 11);
+
+    // More steps than the ring buffer holds, none of them waits
+    for (int i = 0; i < 10; i++)
+        robot.az_sim_fn();
+    BOOST_CHECK_EQUAL(rec.get_dropped_num(), 10);
+    BOOST_CHECK_EQUAL(rec.get_written_num(), 11);
+
+    robot.az_set_recorder(NULL);
+    remove(g_log_fn);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,11 @@
+/**
+ *  @file   test_main.cpp
+ *  @brief  Contains the entry point of the unit tests
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+// Header-only Boost.Test, no library to build with the compiler of the
+// project. The other test files include <boost/test/unit_test.hpp>.
+#define BOOST_TEST_MODULE Robot
+#include <boost/test/included/unit_test.hpp>
@@ -0,0 +1,125 @@
+/**
+ *  @file   test_occupancy_grid.cpp
+ *  @brief  Contains unit tests of the COccupancyGrid distance field
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "occupancy_grid.H"
+#include "raycaster.H"
+#include "counter_rng.H"
+
+#include <math.h>
+#include <boost/test/unit_test.hpp>
+
+/// Wall lines every 150 x 120 cells and scattered single cells.
+static void make_grid(COccupancyGrid *g, int w, int h)
+{
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            bool wall = x % 150 < 3 || y % 120 < 3;
+            bool dot = CCounterRng::uniform(1, (boost::uint64_t) y * w + x) <
+                0.0003;
+            if (wall || dot)
+                g->set_occupied(x, y, true);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(occupancy_grid)
+
+BOOST_AUTO_TEST_CASE(sphere_tracing)
+{
+    const int w = 800;
+    const int h = 600;
+    const int n = 360;
+    COccupancyGrid g(w, h);
+    make_grid(&g, w, h);
+    COccupancyGrid gd(w, h);
+    make_grid(&gd, w, h);
+    gd.compute_distance_field();
+
+    // Sphere tracing over the distance field hits the same cells
+    CRaycaster a;
+    a.set_rays(n, 0.0, 6.283185307179586);
+    a.set_grid(&g);
+    CRaycaster b;
+    b.set_rays(n, 0.0, 6.283185307179586);
+    b.set_grid(&gd);
+
+    int diff = 0;
+    for (int k = 0; k < 200; k++) {
+        CPose p(w * CCounterRng::uniform(3, 3 * k),
+            h * CCounterRng::uniform(3, 3 * k + 1),
+            6.283185307179586 * CCounterRng::uniform(3, 3 * k + 2));
+        a.cast(p, 10.0, 200.0);
+        b.cast(p, 10.0, 200.0);
+
+        for (int i = 0; i < n; i++) {
+            if (a.get_ranges()[i] != b.get_ranges()[i])
+                diff++;
+        }
+    }
+    BOOST_CHECK_EQUAL(diff, 0);
+}
+
+BOOST_AUTO_TEST_CASE(distance_field)
+{
+    // Brute force nearest occupied cell, cells outside of the map count
+    const int w = 57;
+    const int h = 43;
+    COccupancyGrid g(w, h);
+    for (int i = 0; i < 20; i++)
+        g.set_occupied((int) (w * CCounterRng::uniform(4, 2 * i)),
+            (int) (h * CCounterRng::uniform(4, 2 * i + 1)), true);
+    g.compute_distance_field();
+
+    int diff = 0;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            double best = 1e9;
+            for (int j = -1; j <= h; j++) {
+                for (int i = -1; i <= w; i++) {
+                    if (g.is_occupied(i, j)) {
+                        double d = sqrt((double) (i - x) * (i - x) +
+                            (double) (j - y) * (j - y));
+                        if (d < best)
+                            best = d;
+                    }
+                }
+            }
+            if ((int) best != g.get_distance(x, y))
+                diff++;
+        }
+    }
+    BOOST_CHECK_EQUAL(diff, 0);
+}
+
+BOOST_AUTO_TEST_CASE(free_disc)
+{
+    const int w = 300;
+    const int h = 200;
+    COccupancyGrid g(w, h);
+    make_grid(&g, w, h);
+    COccupancyGrid gd(w, h);
+    make_grid(&gd, w, h);
+    gd.compute_distance_field();
+    BOOST_REQUIRE(gd.has_distance_field());
+
+    // One lookup gives the same answer as checking the cells of the disc
+    int diff = 0;
+    for (int k = 0; k < 5000; k++) {
+        double x = w * CCounterRng::uniform(5, 3 * k);
+        double y = h * CCounterRng::uniform(5, 3 * k + 1);
+        double r = 20.0 * CCounterRng::uniform(5, 3 * k + 2);
+        if (g.is_free_disc(x, y, r) != gd.is_free_disc(x, y, r))
+            diff++;
+    }
+    BOOST_CHECK_EQUAL(diff, 0);
+
+    // A changed cell invalidates the field
+    gd.set_occupied(10, 10, true);
+    BOOST_CHECK(!gd.has_distance_field());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+/**
+ *  @file   test_particles.cpp
+ *  @brief  Contains unit tests of the odometry samples of CParticles
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "particles.H"
+#include "counter_rng.H"
+#include "config.H"
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+
+/// Default robot with a large odometry error, so the samples spread.
+static AZ_CONFIG make_config()
+{
+    CConfig c;
+    AZ_CONFIG cfg;
+    c.copy_to(&cfg);
+    cfg.KT = 0.05;
+    cfg.KD = 0.02;
+    cfg.KR = 0.1;
+    cfg.MT = 0.01;
+    cfg.MD = 0.005;
+    cfg.MR = -0.02;
+    return cfg;
+}
+
+/// The error model of CParticles, one particle after the other with the
+/// functions of the C library.
+static void move_reference(const AZ_CONFIG &cfg, boost::uint64_t key,
+    double lspeed, double rspeed, double dt, std::vector<double> &x,
+    std::vector<double> &y, std::vector<double> &th)
+{
+    const double s = cfg.SCALE_FACTOR;
+    const double d = (lspeed + rspeed) / 2 * dt;
+    const double a = (lspeed - rspeed) * dt / cfg.ROBOT_DIAMETER;
+    const double d_m = fabs(d) / s;
+
+    for (size_t i = 0; i < x.size(); i++) {
+        double g0;
+        double g1;
+        double g2;
+        double g3;
+        CCounterRng::gaussian2(key, 2 * i, g0, g1);
+        CCounterRng::gaussian2(key, 2 * i + 1, g2, g3);
+
+        double di = d * (1.0 + cfg.MT) + cfg.KT * s * sqrt(d_m) * s * g0;
+        double ai = a * (1.0 + cfg.MR) + cfg.KR * s * sqrt(fabs(a)) * g1;
+        double th1 = th[i] + ai;
+
+        if (fabs(ai) > 1e-6) {
+            x[i] = x[i] + di / ai * (sin(th1) - sin(th[i]));
+            y[i] = y[i] - di / ai * (cos(th1) - cos(th[i]));
+        }
+        else {
+            x[i] = x[i] + di * cos(th[i]);
+            y[i] = y[i] + di * sin(th[i]);
+        }
+
+        th[i] = th1 + cfg.MD * d_m + cfg.KD * s * sqrt(d_m) * g2;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(particles)
+
+BOOST_AUTO_TEST_CASE(move)
+{
+    AZ_CONFIG cfg = make_config();
+    const boost::uint64_t seed = 1234;
+
+    // Odd, the last particle takes the scalar way
+    for (int n = 1000; n <= 1001; n++) {
+        CParticles p;
+        p.init(&cfg, n, CPose(200.0, 150.0, 0.3), seed);
+
+        std::vector<double> x(n, 200.0);
+        std::vector<double> y(n, 150.0);
+        std::vector<double> th(n, 0.3);
+
+        // Turns both ways, straight lines without rotation error, and a
+        // step which does not move
+        const double speed[][2] = {{60.0, 40.0}, {40.0, 60.0}, {50.0, 50.0},
+            {-30.0, 30.0}, {0.0, 0.0}, {80.0, -10.0}};
+
+        double max_err = 0.0;
+        for (int k = 0; k < 300; k++) {
+            const double *v = speed[(k / 10) % 6];
+            p.move(v[0], v[1], 0.02);
+            move_reference(cfg, CCounterRng::bits(seed, k), v[0], v[1], 0.02,
+                x, y, th);
+
+            for (int i = 0; i < n; i++) {
+                CPose q = p.get_pose(i);
+                max_err = std::max(max_err, fabs(q.x() - x[i]));
+                max_err = std::max(max_err, fabs(q.y() - y[i]));
+                max_err = std::max(max_err, fabs(q.th() - th[i]));
+            }
+        }
+
+        // Polynomials instead of the C library. The arc divides by the turn,
+        // a turn just above 1e-6 multiplies the rounding errors by 1e6.
+        BOOST_CHECK_SMALL(max_err, 1e-6);
+
+        // The samples spread, the error model is applied
+        double sx = 0.0;
+        double sxx = 0.0;
+        for (int i = 0; i < n; i++) {
+            sx = sx + x[i];
+            sxx = sxx + x[i] * x[i];
+        }
+        BOOST_CHECK_GT(sxx / n - (sx / n) * (sx / n), 1.0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
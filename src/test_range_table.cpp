@@ -0,0 +1,150 @@
+/**
+ *  @file   test_range_table.cpp
+ *  @brief  Contains unit tests of the CRangeTable cache file
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "range_table.H"
+#include "world.H"
+
+#include <stdio.h>
+#include <boost/test/unit_test.hpp>
+
+/// Cache file written by the tests, in the working directory.
+static const char *g_cache_fn = "test_range_table.bin";
+
+/// Walls at the border and a few boxes.
+static void make_grid(COccupancyGrid *g, int w, int h)
+{
+    for (int x = 0; x < w; x++) {
+        g->set_occupied(x, 0, true);
+        g->set_occupied(x, h - 1, true);
+    }
+    for (int y = 0; y < h; y++) {
+        g->set_occupied(0, y, true);
+        g->set_occupied(w - 1, y, true);
+    }
+    for (int y = 20; y < 30; y++)
+        for (int x = 40; x < 55; x++)
+            g->set_occupied(x, y, true);
+}
+
+/// Compare two tables at every block and angle.
+static int count_differences(const CRangeTable &a, const CRangeTable &b,
+    int w, int h, int n_angles)
+{
+    int n = 0;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            for (int k = 0; k < n_angles; k++) {
+                double th = 6.283185307179586 * k / n_angles;
+                if (a.get_range(x, y, th) != b.get_range(x, y, th))
+                    n++;
+            }
+        }
+    }
+    return n;
+}
+
+BOOST_AUTO_TEST_SUITE(range_table)
+
+BOOST_AUTO_TEST_CASE(cache_round_trip)
+{
+    const int w = 96;
+    const int h = 64;
+    COccupancyGrid g(w, h);
+    make_grid(&g, w, h);
+
+    remove(g_cache_fn);
+
+    for (int q = 0; q < 2; q++) {
+        bool quantize = (q == 1);
+
+        CRangeTable built;
+        BOOST_REQUIRE_EQUAL(built.load(&g, 32, 60.0, 1, quantize, g_cache_fn), 1);
+        BOOST_CHECK(built.is_loaded());
+        BOOST_CHECK(!built.is_mapped());
+
+        // Second run maps the file, same entries
+        CRangeTable cached;
+        BOOST_REQUIRE_EQUAL(cached.load(&g, 32, 60.0, 1, quantize, g_cache_fn), 0);
+        BOOST_CHECK(cached.is_mapped());
+        BOOST_CHECK_EQUAL(cached.get_max_range(), built.get_max_range());
+        BOOST_CHECK_EQUAL(count_differences(built, cached, w, h, 32), 0);
+
+        // Something was hit, the table is not empty
+        BOOST_CHECK(cached.get_range(48, 10, 1.5707963267948966) > 0.0);
+        BOOST_CHECK(cached.get_range(48, 10, 1.5707963267948966) < 15.0);
+
+        remove(g_cache_fn);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(cache_mismatch)
+{
+    const int w = 96;
+    const int h = 64;
+    COccupancyGrid g(w, h);
+    make_grid(&g, w, h);
+
+    remove(g_cache_fn);
+
+    CRangeTable t;
+    BOOST_REQUIRE_EQUAL(t.load(&g, 32, 60.0, 1, false, g_cache_fn), 1);
+
+    // Other parameters build the table again
+    BOOST_CHECK_EQUAL(t.load(&g, 16, 60.0, 1, false, g_cache_fn), 1);
+    BOOST_CHECK_EQUAL(t.load(&g, 16, 40.0, 1, false, g_cache_fn), 1);
+    BOOST_CHECK_EQUAL(t.load(&g, 16, 40.0, 2, false, g_cache_fn), 1);
+    BOOST_CHECK_EQUAL(t.load(&g, 16, 40.0, 2, false, g_cache_fn), 0);
+
+    // So does another map of the same size
+    g.set_occupied(70, 50, true);
+    BOOST_CHECK_EQUAL(t.load(&g, 16, 40.0, 2, false, g_cache_fn), 1);
+
+    // A file of the other byte order is not used
+    FILE *f = fopen(g_cache_fn, "r+b");
+    BOOST_REQUIRE(f != NULL);
+    unsigned char order[4];
+    unsigned char swapped[4];
+    fseek(f, 8, SEEK_SET);
+    BOOST_REQUIRE_EQUAL(fread(order, 1, 4, f), 4u);
+    for (int i = 0; i < 4; i++)
+        swapped[i] = order[3 - i];
+    fseek(f, 8, SEEK_SET);
+    fwrite(swapped, 1, 4, f);
+    fclose(f);
+    BOOST_CHECK_EQUAL(t.load(&g, 16, 40.0, 2, false, g_cache_fn), 1);
+
+    remove(g_cache_fn);
+}
+
+BOOST_AUTO_TEST_CASE(stale_after_edit)
+{
+    const int w = 96;
+    const int h = 64;
+    CWorld world(w, h);
+    make_grid(world.get_grid(), w, h);
+
+    BOOST_REQUIRE_EQUAL(world.enable_range_table(32, 60.0, 1, false, NULL), 1);
+    const CRangeTable *t = world.get_range_table();
+    BOOST_REQUIRE(t != NULL);
+    BOOST_CHECK(t->is_up_to_date(world.get_grid()));
+    double before = t->get_range(20, 40, 0.0);
+
+    // A new box in front of (20, 40), the old table must not be used
+    for (int y = 35; y < 45; y++)
+        world.get_grid()->set_occupied(30, y, true);
+    BOOST_CHECK(!t->is_up_to_date(world.get_grid()));
+    BOOST_CHECK(world.get_range_table() == NULL);
+
+    // Enabled again, the table sees the box
+    BOOST_REQUIRE_EQUAL(world.enable_range_table(32, 60.0, 1, false, NULL), 1);
+    t = world.get_range_table();
+    BOOST_REQUIRE(t != NULL);
+    BOOST_CHECK(t->get_range(20, 40, 0.0) < before);
+    BOOST_CHECK(t->get_range(20, 40, 0.0) < 11.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+/**
+ *  @file   test_raycaster.cpp
+ *  @brief  Contains unit tests of CRaycaster against the per-ray CSensor
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "raycaster.H"
+#include "sensor.H"
+#include "counter_rng.H"
+
+#include <math.h>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+/// Wall lines every 150 x 120 cells and scattered single cells. There is no
+/// wall at the right and bottom border, so rays leave the map there.
+static void make_grid(COccupancyGrid *g, int w, int h)
+{
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            bool wall = x % 150 < 3 || y % 120 < 3;
+            bool dot = CCounterRng::uniform(1, (boost::uint64_t) y * w + x) <
+                0.0003;
+            if (wall || dot)
+                g->set_occupied(x, y, true);
+        }
+    }
+}
+
+/// Count the rays of CRaycaster::cast() which differ from the rays of
+/// CSensor::update_value(), the original per-ray traversal.
+static int count_differences(CRaycaster *rc, CSensor *s, int n, double offset,
+    double max_range, int poses, int w, int h)
+{
+    const double step = 6.283185307179586 / n;
+    int diff = 0;
+
+    for (int k = 0; k < poses; k++) {
+        CPose p(w * CCounterRng::uniform(2, 3 * k),
+            h * CCounterRng::uniform(2, 3 * k + 1),
+            6.283185307179586 * CCounterRng::uniform(2, 3 * k + 2));
+        rc->cast(p, offset, max_range);
+
+        // Same construction as CRobot::az_update_all_sensors() had
+        CPoint2D start(p.x() + offset, p.y());
+        CPoint2D end(p.x() + offset + max_range, p.y());
+        for (int i = 0; i < n; i++) {
+            s[i].set_start_point(start.rotate_about(p, p.th() + step * i));
+            s[i].set_end_point(end.rotate_about(p, p.th() + step * i));
+            s[i].update_value();
+
+            if (fabs(s[i].get_value() - rc->get_ranges()[i]) > 1e-6)
+                diff++;
+        }
+    }
+
+    return diff;
+}
+
+BOOST_AUTO_TEST_SUITE(raycaster)
+
+BOOST_AUTO_TEST_CASE(same_as_sensor)
+{
+    const int w = 800;
+    const int h = 600;
+    COccupancyGrid g(w, h);
+    make_grid(&g, w, h);
+
+    // A multiple of the SIMD width, and a remainder walked ray by ray
+    const int ray_num[] = {360, 37};
+    for (int r = 0; r < 2; r++) {
+        const int n = ray_num[r];
+        std::vector<CSensor> s(n);
+        for (int i = 0; i < n; i++)
+            s[i].set_grid(&g);
+
+        CRaycaster rc;
+        rc.set_rays(n, 0.0, 6.283185307179586);
+        rc.set_grid(&g);
+
+        // Short and long rays, and rays longer than the map
+        BOOST_CHECK_EQUAL(count_differences(&rc, &s[0], n, 10.0, 60.0, 100, w, h), 0);
+        BOOST_CHECK_EQUAL(count_differences(&rc, &s[0], n, 10.0, 200.0, 100, w, h), 0);
+        BOOST_CHECK_EQUAL(count_differences(&rc, &s[0], n, 0.0, 1000.0, 20, w, h), 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+/**
+ *  @file   test_scheduler.cpp
+ *  @brief  Contains unit tests of CScheduler
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "scheduler.H"
+
+#include <vector>
+#include <boost/thread.hpp>
+#include <boost/chrono.hpp>
+#include <boost/test/unit_test.hpp>
+
+/// Ticks seen by one task, written by the scheduler thread only.
+struct AZ_TEST_TASK
+{
+    std::vector<int> ticks;
+};
+
+static void record_tick(int tick, void *data)
+{
+    ((AZ_TEST_TASK *) data)->ticks.push_back(tick);
+}
+
+/// Wall clock start of every tick, written by the scheduler thread only.
+static std::vector<boost::chrono::steady_clock::time_point> g_tick_wall;
+
+static void record_wall(int tick, void *data)
+{
+    g_tick_wall.push_back(boost::chrono::steady_clock::now());
+}
+
+static void set_flag(void *data)
+{
+    *(int *) data = 1;
+}
+
+BOOST_AUTO_TEST_SUITE(scheduler)
+
+BOOST_AUTO_TEST_CASE(lockstep)
+{
+    CScheduler s;
+    AZ_TEST_TASK a;
+    AZ_TEST_TASK b;
+    s.add_task(record_tick, &a);
+    s.add_task(record_tick, &b);
+    s.add_task(record_tick, &a); // Duplicate, ignored
+
+    s.set_lockstep(true);
+    s.start();
+
+    s.step(5);
+    BOOST_CHECK_EQUAL(s.get_tick_number(), 5);
+    BOOST_REQUIRE_EQUAL(a.ticks.size(), 5u);
+    BOOST_REQUIRE_EQUAL(b.ticks.size(), 5u);
+
+    // Consecutive ticks from 0, the same for every task
+    for (int i = 0; i < 5; i++) {
+        BOOST_CHECK_EQUAL(a.ticks[i], i);
+        BOOST_CHECK_EQUAL(b.ticks[i], a.ticks[i]);
+    }
+
+    s.step();
+    s.step(2);
+    BOOST_CHECK_EQUAL(s.get_tick_number(), 8);
+    BOOST_CHECK_EQUAL(a.ticks.size(), 8u);
+
+    s.remove_task(record_tick, &a);
+    s.step(3);
+    BOOST_CHECK_EQUAL(a.ticks.size(), 8u);
+    BOOST_CHECK_EQUAL(b.ticks.size(), 11u);
+
+    s.stop();
+    BOOST_CHECK(!s.is_running());
+}
+
+BOOST_AUTO_TEST_CASE(call)
+{
+    CScheduler s;
+    int flag = 0;
+
+    // Also without a run
+    s.call(set_flag, &flag);
+    BOOST_CHECK_EQUAL(flag, 1);
+
+    AZ_TEST_TASK a;
+    s.add_task(record_tick, &a);
+    s.set_lockstep(true);
+    s.start();
+    s.step(2);
+
+    flag = 0;
+    s.call(set_flag, &flag);
+    BOOST_CHECK_EQUAL(flag, 1);
+
+    // A job is not a tick
+    BOOST_CHECK_EQUAL(a.ticks.size(), 2u);
+    s.stop();
+}
+
+BOOST_AUTO_TEST_CASE(rtf)
+{
+    const double dt = 0.01;
+    const int n = 20;
+
+    for (int k = 1; k <= 2; k++) {
+        double rtf = (double) k;
+
+        CScheduler s;
+        s.add_task(record_wall, NULL);
+        s.set_time_step(dt);
+        s.set_rtf(rtf);
+        g_tick_wall.clear();
+        s.start();
+
+        while (s.get_tick_number() < n + 1)
+            boost::this_thread::yield();
+        s.stop();
+
+        // Tick i simulates from i * dt, it must not start before the wall
+        // clock gets there. Tick 0 starts the clocks.
+        BOOST_REQUIRE(g_tick_wall.size() >= (size_t) n + 1);
+        for (int i = 1; i <= n; i++) {
+            double wall = boost::chrono::duration<double>(
+                g_tick_wall[i] - g_tick_wall[0]).count();
+            BOOST_CHECK_GE(wall, i * dt / rtf - 1e-4);
+        }
+
+        // Not late either, with some margin for a busy machine
+        double wall = boost::chrono::duration<double>(
+            g_tick_wall[n] - g_tick_wall[0]).count();
+        BOOST_CHECK_LT(wall, n * dt / rtf + 0.1);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+/**
+ *  @file   test_simulation_host.cpp
+ *  @brief  Contains unit tests of CRobot driven by the scheduler of a
+ *          CSimulationHost
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "simulation_host.H"
+#include "scheduler.H"
+#include "robot.H"
+#include "world.H"
+#include "config.H"
+
+#include <math.h>
+#include <boost/thread.hpp>
+#include <boost/test/unit_test.hpp>
+
+/// Host without a window: a world with walls at the border and a scheduler.
+class CTestHost : public CSimulationHost
+{
+public:
+    CTestHost()
+    :m_world(200, 200)
+    {
+        COccupancyGrid *grid = m_world.get_grid();
+        for (int i = 0; i < 200; i++) {
+            grid->set_occupied(i, 0, true);
+            grid->set_occupied(i, 199, true);
+            grid->set_occupied(0, i, true);
+            grid->set_occupied(199, i, true);
+        }
+    }
+
+    virtual CWorld *get_world() { return &m_world; }
+    virtual CScheduler *get_scheduler() { return &m_scheduler; }
+    virtual void attach_robot(CRobot *r) {}
+    virtual void set_sensor_values_properties_window(const double *v, int n) {}
+
+private:
+    CWorld m_world;
+    CScheduler m_scheduler;
+};
+
+/// Turn on the spot.
+class CHostTestRobot : public CRobot
+{
+public:
+    CHostTestRobot(CSimulationHost *host)
+    :CRobot(host)
+    {
+    }
+
+    virtual void az_sim_fn()
+    {
+        az_set_lspeed(0.2);
+        az_set_rspeed(-0.2);
+        az_step();
+    }
+};
+
+/// Wait until n more ticks are finished.
+static void wait_ticks(CScheduler *s, int n)
+{
+    int tick = s->get_tick_number();
+    while (s->get_tick_number() < tick + n)
+        boost::this_thread::yield();
+}
+
+/// Number of ranges which differ from the distance to the hit point.
+static int count_noisy(const AZ_ROBOT_SNAPSHOT &snap)
+{
+    int n = 0;
+    for (size_t i = 0; i < snap.range.size(); i++) {
+        CPoint2D start = snap.start[i];
+        CPoint2D hit = snap.hit[i];
+        if (fabs(snap.range[i] - hit.measure_from(start)) > 1e-6)
+            n++;
+    }
+    return n;
+}
+
+BOOST_AUTO_TEST_SUITE(simulation_host)
+
+BOOST_AUTO_TEST_CASE(flags_while_running)
+{
+    CTestHost host;
+    CHostTestRobot robot(&host);
+
+    CConfig c;
+    AZ_CONFIG cfg;
+    c.copy_to(&cfg);
+    cfg.LIDAR_RAYS = 36;
+    cfg.LIDAR_START_ANGLE = 0.0;
+    cfg.LIDAR_SWEEP_ANGLE = 6.283185307179586;
+    robot.az_set_config(&cfg);
+    robot.az_request_location(0.5, 0.5, 0.0);
+
+    // Toggled from this thread while the ticks run unbounded
+    CScheduler *s = host.get_scheduler();
+    s->set_rtf(0.0);
+    s->start();
+    for (int k = 0; k < 200; k++) {
+        robot.az_enable_noise(k % 2 == 0);
+        robot.az_enable_debug_beam(k % 3 == 0);
+    }
+
+    for (int on = 1; on >= 0; on--) {
+        robot.az_enable_noise(on == 1);
+        robot.az_enable_debug_beam(on == 1);
+        wait_ticks(s, 5);
+
+        // This thread is the reader of the snapshot, like the UI thread
+        const AZ_ROBOT_SNAPSHOT &snap = robot.az_get_snapshot();
+        BOOST_REQUIRE_EQUAL(snap.range.size(), 36u);
+        BOOST_CHECK_EQUAL(snap.br.empty(), on == 0);
+        BOOST_CHECK_EQUAL(count_noisy(snap) > 0, on == 1);
+    }
+
+    s->stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,63 @@
+/**
+ *  @file   test_thread_pool.cpp
+ *  @brief  Contains unit tests of CThreadPool
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "thread_pool.H"
+
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+/// Count how many times each index is executed.
+static void count_task(int i, void *data)
+{
+    std::vector<boost::atomic<int> > *n =
+        (std::vector<boost::atomic<int> > *) data;
+    (*n)[i].fetch_add(1);
+}
+
+BOOST_AUTO_TEST_SUITE(thread_pool)
+
+BOOST_AUTO_TEST_CASE(every_index_once)
+{
+    const int threads[] = {1, 2, 4};
+    const int sizes[] = {0, 1, 7, 100, 1000};
+    const int grains[] = {1, 3, 64, 5000};
+
+    for (int t = 0; t < 3; t++) {
+        CThreadPool pool(threads[t]);
+        BOOST_CHECK_EQUAL(pool.get_thread_num(), threads[t]);
+
+        for (int s = 0; s < 5; s++) {
+            for (int g = 0; g < 4; g++) {
+                std::vector<boost::atomic<int> > n(sizes[s] + 1);
+                for (size_t i = 0; i < n.size(); i++)
+                    n[i] = 0;
+
+                pool.parallel_for(sizes[s], count_task, &n, grains[g]);
+
+                // The extra element must not be touched
+                for (int i = 0; i <= sizes[s]; i++)
+                    BOOST_REQUIRE_EQUAL((int) n[i], (i < sizes[s]) ? 1 : 0);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reuse)
+{
+    CThreadPool pool(4);
+    std::vector<boost::atomic<int> > n(500);
+    for (size_t i = 0; i < n.size(); i++)
+        n[i] = 0;
+
+    for (int k = 0; k < 100; k++)
+        pool.parallel_for((int) n.size(), count_task, &n, 8);
+
+    for (size_t i = 0; i < n.size(); i++)
+        BOOST_REQUIRE_EQUAL((int) n[i], 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
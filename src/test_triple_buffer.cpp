@@ -0,0 +1,87 @@
+/**
+ *  @file   test_triple_buffer.cpp
+ *  @brief  Contains unit tests of CTripleBuffer
+ *  @author Auralius Manurung <manurunga@yandex.com>
+ *  @date   10/16/2026
+ */
+
+#include "triple_buffer.H"
+
+#include <boost/thread.hpp>
+#include <boost/test/unit_test.hpp>
+
+/// Every value of a complete copy equals its sequence number.
+struct AZ_TEST_FRAME
+{
+    int seq;
+    int v[64];
+};
+
+/// Number of frames published by the writer thread.
+static const int g_frame_num = 200000;
+
+static void fill(AZ_TEST_FRAME &f, int seq)
+{
+    f.seq = seq;
+    for (int i = 0; i < 64; i++)
+        f.v[i] = seq;
+}
+
+static void write_frames(CTripleBuffer<AZ_TEST_FRAME> *b)
+{
+    for (int s = 1; s <= g_frame_num; s++) {
+        fill(b->get_back(), s);
+        b->publish();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(triple_buffer)
+
+BOOST_AUTO_TEST_CASE(latest_value)
+{
+    CTripleBuffer<AZ_TEST_FRAME> b;
+    fill(b.get_back(), 0);
+    b.publish();
+    BOOST_CHECK_EQUAL(b.read().seq, 0);
+
+    // Nothing new, the same copy again
+    BOOST_CHECK_EQUAL(b.read().seq, 0);
+
+    // Only the last of several publications is seen
+    for (int s = 1; s <= 5; s++) {
+        fill(b.get_back(), s);
+        b.publish();
+    }
+    BOOST_CHECK_EQUAL(b.read().seq, 5);
+    BOOST_CHECK_EQUAL(b.read().seq, 5);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent)
+{
+    CTripleBuffer<AZ_TEST_FRAME> b;
+    fill(b.get_back(), 0);
+    b.publish();
+
+    boost::thread writer(write_frames, &b);
+
+    int last = 0;
+    int torn = 0;
+    int older = 0;
+    while (last < g_frame_num) {
+        const AZ_TEST_FRAME &f = b.read();
+        for (int i = 0; i < 64; i++) {
+            if (f.v[i] != f.seq)
+                torn++;
+        }
+        if (f.seq < last)
+            older++;
+        last = f.seq;
+    }
+    writer.join();
+
+    BOOST_CHECK_EQUAL(torn, 0);
+    BOOST_CHECK_EQUAL(older, 0);
+    BOOST_CHECK_EQUAL(b.read().seq, g_frame_num);
+}
+
+BOOST_AUTO_TEST_SUITE_END()